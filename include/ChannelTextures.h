@@ -0,0 +1,40 @@
+#ifndef CHANNEL_TEXTURES_H
+#define CHANNEL_TEXTURES_H
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+#include "Config.h"
+#include "Shader.h"
+
+// 场景纹理输入 iChannel0..3：图像文件或预计算的噪声查找表
+class ChannelTextures {
+public:
+    // 噪声查找表的磁盘缓存目录（相对于工作目录）
+    static constexpr const char* kCacheDir = "cache";
+
+    explicit ChannelTextures(const std::vector<ChannelConfig>& channels);
+    ~ChannelTextures();
+
+    // 禁止拷贝
+    ChannelTextures(const ChannelTextures&) = delete;
+    ChannelTextures& operator=(const ChannelTextures&) = delete;
+
+    // 绑定到纹理单元 0..3 并设置 iChannelN / iChannelResolution（需已 use()）
+    // 其他通道也会占用低编号纹理单元，所以每次绘制前都要调用
+    void bind(Shader& shader) const;
+
+    bool empty() const { return textures.empty(); }
+
+private:
+    struct Channel {
+        GLuint texture;
+        int width;
+        int height;
+        std::string samplerName;     // 预先拼好的 uniform 名，避免每帧构造字符串
+        std::string resolutionName;
+    };
+    std::vector<Channel> textures;
+};
+
+#endif // CHANNEL_TEXTURES_H
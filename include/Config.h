@@ -3,14 +3,52 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
+// 注视点渲染配置（以鼠标为中心）
+// 半径以帧缓冲高度为单位，保证不同分辨率下视觉范围一致
+struct FoveationConfig {
+    bool enabled = false;
+    float innerRadius = 0.15f;    // 全分辨率区域半径
+    float outerRadius = 0.30f;    // 过渡带外半径，之外只显示低分辨率外围
+    float peripheryScale = 0.5f;  // 外围渲染分辨率缩放 (0, 1]
+};
+
+// 低分辨率距离预通道配置（光线步进场景）
+// 场景着色器需按 shaders/prepass_common.glsl 中的约定实现 TR_PREPASS_WRITE/READ 分支
+struct PrepassConfig {
+    bool enabled = false;
+    int scale = 4;  // 每个预通道像素覆盖 scale x scale 个全分辨率像素（4 或 8）
+};
+
+// 纹理输入配置（Shadertoy 风格的 iChannel0..3）
+struct ChannelConfig {
+    std::string type = "image";  // image / value_noise / perlin_noise / blue_noise
+    std::string path;            // type 为 image 时的图像文件（二进制 PPM/PGM）
+    int size = 256;              // 噪声查找表边长
+    unsigned int seed = 1;       // 噪声种子
+    bool mipmaps = true;
+    bool linearFilter = true;    // false=最近邻（蓝噪声抖动常用）
+};
+
+// 网格资源配置；path 为空表示全屏四边形场景
+struct MeshConfig {
+    std::string path;   // .obj（首次加载时转换并缓存）或 .trmesh
+    int instances = 1;  // 实例化绘制的实例数
+};
+
 // 着色器场景配置
 struct ShaderScene {
     std::string name;
     std::string description;
     std::string vertexShader;
     std::string fragmentShader;
+    FoveationConfig foveation;
+    PrepassConfig prepass;
+    std::vector<ChannelConfig> channels;  // 最多 4 个
+    std::vector<std::string> defines;     // 注入到片段着色器的宏，用于场景变体
+    MeshConfig mesh;
 };
 
 // 窗口配置
@@ -69,6 +107,10 @@ private:
     GPUConfig gpuConfig;
     
     void loadScenes(const YAML::Node& config);
+    void loadFoveationConfig(const YAML::Node& node, FoveationConfig& foveation);
+    void loadPrepassConfig(const YAML::Node& node, PrepassConfig& prepass);
+    void loadChannelConfigs(const YAML::Node& node, std::vector<ChannelConfig>& channels);
+    void loadMeshConfig(const YAML::Node& node, ShaderScene& scene);
     void loadWindowConfig(const YAML::Node& config);
     void loadPerformanceConfig(const YAML::Node& config);
     void loadGPUConfig(const YAML::Node& config);
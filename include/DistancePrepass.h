@@ -0,0 +1,59 @@
+#ifndef DISTANCE_PREPASS_H
+#define DISTANCE_PREPASS_H
+
+#include <GL/glew.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Config.h"
+#include "Shader.h"
+
+// 低分辨率距离预通道：以块为单位做保守的锥形步进，
+// 把安全起始距离写入浮点纹理，供全分辨率通道跳过空白区域
+class DistancePrepass {
+public:
+    // 为着色器设置场景 uniform（iTime/iResolution/iMouse 等）
+    using SetUniformsFn = std::function<void(Shader& shader, int width, int height)>;
+
+    // 公共代码文件与注入的宏，场景着色器据此实现两种分支
+    static constexpr const char* kPreludePath = "shaders/prepass_common.glsl";
+    static constexpr const char* kWriteDefine = "TR_PREPASS_WRITE";
+    static constexpr const char* kReadDefine = "TR_PREPASS_READ";
+
+    explicit DistancePrepass(const ShaderScene& scene);
+    ~DistancePrepass();
+
+    // 禁止拷贝
+    DistancePrepass(const DistancePrepass&) = delete;
+    DistancePrepass& operator=(const DistancePrepass&) = delete;
+
+    // 为 width x height 的全分辨率目标执行预通道；调用方开启裁剪时只计算裁剪区域覆盖的块
+    // 结束后恢复帧缓冲、视口与裁剪状态
+    void run(int width, int height, const SetUniformsFn& setUniforms);
+
+    // 把距离纹理绑定给全分辨率着色器（需已 use()）
+    void bind(Shader& sceneShader) const;
+
+private:
+    static constexpr GLuint kTextureUnit = 4;
+    // 注视点渲染每帧以外围/全分辨率各执行一次，按尺寸保留两个目标避免反复重建
+    static constexpr size_t kMaxTargets = 2;
+
+    struct Target {
+        GLuint fbo;
+        GLuint texture;
+        int width;   // 块数
+        int height;
+    };
+
+    int scale;
+    Shader prepassShader;
+    std::vector<Target> targets;  // 最近使用的在前，front() 为本次 run() 写入的目标
+
+    static std::vector<std::string> prepassDefines(const ShaderScene& scene);
+    const Target& acquireTarget(int width, int height);
+    static Target createTarget(int width, int height);
+    static void destroyTarget(const Target& target);
+};
+
+#endif // DISTANCE_PREPASS_H
@@ -0,0 +1,44 @@
+#ifndef FOVEATED_RENDERER_H
+#define FOVEATED_RENDERER_H
+
+#include <GL/glew.h>
+#include <functional>
+#include "Config.h"
+#include "Shader.h"
+
+// 注视点渲染：鼠标附近全分辨率着色，外围以低分辨率着色后合成
+class FoveatedRenderer {
+public:
+    // 场景绘制回调，参数为当前渲染目标的分辨率
+    using DrawSceneFn = std::function<void(int width, int height)>;
+
+    explicit FoveatedRenderer(const FoveationConfig& config);
+    ~FoveatedRenderer();
+
+    // 禁止拷贝
+    FoveatedRenderer(const FoveatedRenderer&) = delete;
+    FoveatedRenderer& operator=(const FoveatedRenderer&) = delete;
+
+    // 渲染一帧到默认帧缓冲，cursorX/cursorY 为帧缓冲像素坐标（左下角为原点）
+    void render(int width, int height, float cursorX, float cursorY, const DrawSceneFn& drawScene);
+
+private:
+    FoveationConfig config;
+    Shader compositeShader;
+
+    GLuint peripheryFBO;
+    GLuint peripheryTexture;
+    GLuint foveaFBO;
+    GLuint foveaTexture;
+    int targetWidth;
+    int targetHeight;
+    int peripheryWidth;
+    int peripheryHeight;
+
+    // 帧缓冲尺寸变化时重建渲染目标
+    void resize(int width, int height);
+    void createTarget(GLuint& fbo, GLuint& texture, int width, int height, GLenum filter);
+    void destroyTargets();
+};
+
+#endif // FOVEATED_RENDERER_H
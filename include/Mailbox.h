@@ -0,0 +1,47 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <atomic>
+#include <cstdint>
+
+// 单写者/单读者无锁信箱（三缓冲）
+// 写者总是写入私有的 back 槽位，再与共享的 middle 槽位原子交换；
+// 读者在有新数据时把 middle 换到自己的 front 槽位。双方互不阻塞，读者始终拿到最新值。
+template <typename T>
+class Mailbox {
+public:
+    Mailbox() = default;
+
+    // 禁止拷贝
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    // 写者线程调用
+    void publish(const T& value) {
+        slots[backIndex] = value;
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | kFreshBit), std::memory_order_acq_rel);
+        backIndex = previous & kIndexMask;
+    }
+
+    // 读者线程调用；返回自上次读取以来是否有新数据，out 总是最新值
+    bool read(T& out) {
+        bool fresh = (middle.load(std::memory_order_relaxed) & kFreshBit) != 0;
+        if (fresh) {
+            uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & kIndexMask;
+        }
+        out = slots[frontIndex];
+        return fresh;
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;
+
+    T slots[3] = {};
+    std::atomic<uint8_t> middle{1};
+    uint8_t backIndex = 0;   // 仅写者访问
+    uint8_t frontIndex = 2;  // 仅读者访问
+};
+
+#endif // MAILBOX_H
@@ -0,0 +1,33 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 只读内存映射文件（POSIX mmap），析构时自动解除映射
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    // 禁止拷贝
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return static_cast<const char*>(mapping); }
+    size_t size() const { return length; }
+
+    // 源文件的修改时间（纳秒），用于判断派生缓存是否过期
+    int64_t modifiedTime() const { return mtime; }
+
+    // 提示内核按顺序预读，适合一次性从头读到尾
+    void adviseSequential() const;
+
+private:
+    void* mapping;
+    size_t length;
+    int64_t mtime;
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,40 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <GL/glew.h>
+#include "Config.h"
+#include "MeshCache.h"
+#include "Shader.h"
+
+// GPU 端三角网格：顶点/索引在加载时一次性写入（支持时为不可变存储），按实例数做索引绘制
+class Mesh {
+public:
+    // 转换后的 .trmesh 缓存目录（相对于工作目录）
+    static constexpr const char* kCacheDir = "cache";
+
+    explicit Mesh(const MeshConfig& config);
+    ~Mesh();
+
+    // 禁止拷贝
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    // 设置 iMeshCenter/iMeshRadius/iInstanceCount 并绘制（需已 use()）
+    void draw(Shader& shader) const;
+
+private:
+    GLuint vao;
+    GLuint vbo;
+    GLuint ebo;
+    bool immutableStorage;  // ARB_buffer_storage 可用时使用 glBufferStorage
+    GLsizei indexCount;
+    GLsizei instanceCount;
+    float center[3];
+    float radius;
+
+    // 从映射的 .trmesh 直接写入 GPU 缓冲，中间不经过额外拷贝
+    void upload(const MeshView& view);
+    void createBuffer(GLenum target, GLuint& buffer, const void* source, size_t bytes);
+};
+
+#endif // MESH_H
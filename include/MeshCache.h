@@ -0,0 +1,45 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+
+// 交错顶点布局：位置 + 法线
+struct MeshVertex {
+    float position[3];
+    float normal[3];
+};
+
+// .trmesh 文件头，之后依次是 vertexCount 个 MeshVertex 与 indexCount 个 uint32 索引
+struct MeshFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;   // 源 OBJ 的大小与修改时间，用于判断缓存是否过期
+    int64_t sourceMtime;   // 纳秒
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    float boundsMin[3];
+    float boundsMax[3];
+};
+
+// 指向映射文件内部的只读视图，不拷贝数据
+struct MeshView {
+    const MeshFileHeader* header = nullptr;
+    const MeshVertex* vertices = nullptr;
+    const uint32_t* indices = nullptr;
+};
+
+// 网格资源的离线转换与二进制缓存
+namespace MeshCache {
+    // 返回可直接映射的 .trmesh 路径；OBJ 源文件在缓存缺失或过期时转换一次
+    std::string prepare(const std::string& sourcePath, const std::string& cacheDir);
+
+    // 直接在映射内存上解析 OBJ（v / vn / f，多边形按扇形三角化），写出 .trmesh
+    void convertObj(const MappedFile& obj, const std::string& outPath);
+
+    // 校验并解析 .trmesh（文件头、长度与索引范围）；格式不符时抛出异常
+    MeshView view(const MappedFile& file);
+}
+
+#endif // MESH_CACHE_H
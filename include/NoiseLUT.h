@@ -0,0 +1,38 @@
+#ifndef NOISE_LUT_H
+#define NOISE_LUT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// RGBA8 图像，行从下到上存放（与 OpenGL 纹理坐标一致）
+struct LUTImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;  // width * height * 4
+};
+
+// 预计算的噪声查找表与磁盘缓存
+namespace NoiseLUT {
+    // 白噪声：每个纹素 4 个独立随机字节，配合线性过滤即为 value noise
+    LUTImage generateValueNoise(int size, uint32_t seed);
+    // 可平铺的梯度噪声：RGBA 分别为 4/8/16/32 个周期的倍频
+    LUTImage generatePerlinNoise(int size, uint32_t seed);
+    // 蓝噪声（简化 void-and-cluster）：RGBA 为 4 张独立的排序抖动图
+    LUTImage generateBlueNoise(int size, uint32_t seed);
+
+    // 按类型生成，type 为 value_noise / perlin_noise / blue_noise
+    LUTImage generate(const std::string& type, int size, uint32_t seed);
+
+    // 先查缓存，未命中则生成并写入缓存
+    LUTImage loadOrGenerate(const std::string& cacheDir, const std::string& type, int size, uint32_t seed);
+
+    // 二进制缓存文件读写；读取失败（不存在/版本不符/损坏）返回 false
+    bool readCache(const std::string& path, LUTImage& image);
+    bool writeCache(const std::string& path, const LUTImage& image);
+
+    // 读取二进制 PPM (P6) / PGM (P5) 图像并转为 RGBA，垂直翻转为 OpenGL 行序
+    LUTImage loadImage(const std::string& path);
+}
+
+#endif // NOISE_LUT_H
@@ -4,6 +4,7 @@
 #include <GL/glew.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class Shader {
 public:
@@ -11,6 +12,9 @@ public:
     Shader(const std::string& vertexSource, const std::string& fragmentSource);
     // 从文件加载着色器的构造函数
     Shader(const std::string& vertexPath, const std::string& fragmentPath, bool fromFile);
+    // 从文件加载，并在片段着色器 #version 之后注入宏定义与可选的公共代码文件
+    Shader(const std::string& vertexPath, const std::string& fragmentPath,
+           const std::vector<std::string>& defines, const std::string& preludePath = "");
     ~Shader();
 
     // 顶点数据设置
@@ -37,8 +41,12 @@ private:
     GLuint vbo;  // 顶点缓冲对象
     std::unordered_map<std::string, GLint> uniformLocationCache;
 
+    // 编译shader并链接程序
+    void build(const std::string& vertexCode, const std::string& fragmentCode);
     // 编译shader
     GLuint compileShader(GLenum type, const std::string& source);
+    // 在 #version 行之后插入文本
+    static std::string injectPreamble(const std::string& source, const std::string& preamble);
     // 从文件读取shader源码
     std::string readFile(const std::string& path);
     // 检查shader编译错误
@@ -5,6 +5,18 @@
 #include <GLFW/glfw3.h>
 #include <string>
 #include "Config.h"
+#include "Mailbox.h"
+
+// 主线程采集、渲染线程读取的输入快照
+struct InputState {
+    double cursorX = 0.0;          // 窗口坐标（左上角原点）
+    double cursorY = 0.0;
+    double cursorTimestamp = 0.0;  // 最近一次鼠标事件的时间（glfwGetTime）
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    int windowWidth = 0;
+    int windowHeight = 0;
+};
 
 class Window {
 public:
@@ -18,12 +30,17 @@ public:
 
     // 窗口状态检查
     bool shouldClose() const;
+    void requestClose();  // 任意线程可调用
     bool isValid() const { return window != nullptr; }
 
     // 窗口操作
     void makeContextCurrent();
     void swapBuffers();
     void pollEvents();
+    void waitEvents();  // 阻塞直到有事件，仅主线程
+
+    // 将鼠标/尺寸事件发布到信箱（仅主线程调用）
+    void attachInput(Mailbox<InputState>& mailbox);
 
     // 获取窗口属性
     void getFramebufferSize(int& width, int& height) const;
@@ -37,14 +54,25 @@ public:
     static void initGLFW();
     static void terminateGLFW();
     static void setGPUConfig(const GPUConfig& config);  // 新增：设置GPU配置
+    static void detachCurrentContext();  // 释放当前线程的上下文，以便交给渲染线程
+    static void wakeEventLoop();         // 唤醒阻塞在 waitEvents 的主线程，任意线程可调用
 
 private:
     GLFWwindow* window;
     bool initialized;
     static GPUConfig gpuConfig;  // 新增：存储GPU配置
 
+    // 输入发布（仅主线程访问）
+    Mailbox<InputState>* inputMailbox;
+    InputState inputState;
+
     void setupWindow(int width, int height, const std::string& title);
     void initGLEW();
+
+    // GLFW 回调
+    static void cursorPosCallback(GLFWwindow* glfwWindow, double xpos, double ypos);
+    static void framebufferSizeCallback(GLFWwindow* glfwWindow, int width, int height);
+    static void windowSizeCallback(GLFWwindow* glfwWindow, int width, int height);
 };
 
 #endif // WINDOW_H
\ No newline at end of file
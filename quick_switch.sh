@@ -13,6 +13,8 @@ if [ $# -eq 0 ]; then
     echo "  rotation_matrix  - 旋转矩阵效果"
     echo "  fractal          - 分形光线追踪"
     echo "  water            - 水面效果"
+    echo "  water_lut        - 水面效果（噪声查找表）"
+    echo "  mesh_instances   - 实例化三角网格"
     echo ""
     echo "示例:"
     echo "  $0 fractal"
@@ -42,6 +44,14 @@ case $SCENE in
         SCENE_NAME="water"
         DISPLAY_NAME="Water Effect"
         ;;
+    water_lut|wl)
+        SCENE_NAME="water_lut"
+        DISPLAY_NAME="Water Effect (Noise LUT)"
+        ;;
+    mesh_instances|mesh|m)
+        SCENE_NAME="mesh_instances"
+        DISPLAY_NAME="Instanced Mesh"
+        ;;
     *)
         echo "错误: 未知场景 '$SCENE'"
         exit 1
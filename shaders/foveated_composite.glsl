@@ -0,0 +1,23 @@
+#version 330 core
+
+uniform sampler2D iPeriphery;   // 低分辨率外围
+uniform sampler2D iFovea;       // 全分辨率注视区
+uniform vec2  iResolution;
+uniform vec2  iCursor;          // 帧缓冲像素坐标
+uniform float iInnerRadius;     // 像素
+uniform float iOuterRadius;     // 像素
+
+out vec4 fragColor;
+
+void main() {
+    vec4 periphery = texture(iPeriphery, gl_FragCoord.xy / iResolution);
+
+    // 内半径内完全使用注视区，过渡带内 smoothstep 混合
+    float w = 1.0 - smoothstep(iInnerRadius, iOuterRadius, distance(gl_FragCoord.xy, iCursor));
+    if (w <= 0.0) {
+        fragColor = periphery;
+        return;
+    }
+    vec4 fovea = texelFetch(iFovea, ivec2(gl_FragCoord.xy), 0);
+    fragColor = mix(periphery, fovea, w);
+}
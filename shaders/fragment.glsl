@@ -25,7 +25,11 @@ float map(vec3 p){
     return dot(sign(p), p) / 5.0;
 }
 vec4 rm(vec3 ro, vec3 rd){
+#ifdef TR_PREPASS_READ
+    float t = prepassStartDistance();
+#else
     float t = 0.0;
+#endif
     vec3 col = vec3(0.0);
     float d;
     for(float i = 0.0; i < 64.0; ++i){
@@ -38,8 +42,27 @@ vec4 rm(vec3 ro, vec3 rd){
     }
     return vec4(col, 1.0 / (d * 100.0));
 }
+#ifdef TR_PREPASS_WRITE
+// 锥形步进：块内所有光线都在半径 t*coneSlope 的锥内。
+// 步长扣除锥半径并按 (1 + coneSlope) 缩小，保证相邻光线也不会越过表面
+float coneMarch(vec3 ro, vec3 rd, float coneSlope){
+    float t = 0.0;
+    for(float i = 0.0; i < 64.0; ++i){
+        float d = map(ro + rd * t) * 0.5 - t * coneSlope;
+        if(d < 0.02) break;
+        if(d > 100.0) break;
+        t += d / (1.0 + coneSlope);
+    }
+    return t;
+}
+#endif
 void main(){
-    vec2 uv = (gl_FragCoord.xy - iResolution.xy * 0.5) / iResolution.x;
+#ifdef TR_PREPASS
+    vec2 fragCoord = prepassFragCoord();
+#else
+    vec2 fragCoord = gl_FragCoord.xy;
+#endif
+    vec2 uv = (fragCoord - iResolution.xy * 0.5) / iResolution.x;
     vec3 ro = vec3(0.0, 0.0, -50.0);
     ro.xz = rotate(ro.xz, iTime);
     vec3 cf = normalize(-ro);
@@ -47,5 +70,11 @@ void main(){
     vec3 cu = normalize(cross(cf, cs));
     vec3 uuv = ro + cf*3.0 + uv.x*cs + uv.y*cu;
     vec3 rd  = normalize(uuv - ro);
+#ifdef TR_PREPASS_WRITE
+    // uv 每像素 1/iResolution.x，焦距 3.0
+    float coneSlope = prepassBlockRadius() / (iResolution.x * 3.0);
+    fragColor = vec4(coneMarch(ro, rd, coneSlope), 0.0, 0.0, 1.0);
+#else
     fragColor = rm(ro, rd);
+#endif
 }
\ No newline at end of file
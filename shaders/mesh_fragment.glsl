@@ -0,0 +1,15 @@
+#version 330 core
+
+in vec3 vNormal;
+in vec3 vWorldPos;
+
+out vec4 fragColor;
+
+void main() {
+    vec3 n = normalize(vNormal);
+    vec3 light = normalize(vec3(0.4, 1.0, 0.6));
+    float diff = max(dot(n, light), 0.0);
+    // 按世界坐标取调色板，区分不同实例
+    vec3 base = 0.5 + 0.5 * cos(vec3(0.0, 2.0, 4.0) + vWorldPos.x * 0.5 + vWorldPos.z * 0.3);
+    fragColor = vec4(base * (0.15 + 0.85 * diff), 1.0);
+}
@@ -0,0 +1,57 @@
+#version 330 core
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+
+uniform float iTime;
+uniform vec2  iResolution;
+uniform vec2  iMouse;
+uniform vec3  iMeshCenter;     // 网格包围盒中心
+uniform float iMeshRadius;     // 网格包围球半径
+uniform int   iInstanceCount;
+
+out vec3 vNormal;
+out vec3 vWorldPos;
+
+mat3 rotY(float a) {
+    float c = cos(a), s = sin(a);
+    return mat3(c, 0.0, -s, 0.0, 1.0, 0.0, s, 0.0, c);
+}
+mat3 rotX(float a) {
+    float c = cos(a), s = sin(a);
+    return mat3(1.0, 0.0, 0.0, 0.0, c, s, 0.0, -s, c);
+}
+
+void main() {
+    // 实例排成正方形网格，每个实例以不同相位自转
+    int side = int(ceil(sqrt(float(iInstanceCount))));
+    vec2 cell = vec2(float(gl_InstanceID % side), float(gl_InstanceID / side)) - 0.5 * float(side - 1);
+    float spin = iTime + float(gl_InstanceID) * 0.37;
+    mat3 model = rotY(spin) * rotX(spin * 0.7);
+
+    // 归一化到单位球后缩放，保证任意尺寸的资源都能放进网格单元
+    vec3 local = (aPos - iMeshCenter) / iMeshRadius;
+    vec3 world = model * local * 0.4 + vec3(cell.x, 0.0, cell.y);
+
+    // 相机绕原点旋转，鼠标水平位置控制方位角
+    float yaw = iTime * 0.2 + iMouse.x * 0.005;
+    float dist = float(side) * 1.2 + 2.0;
+    vec3 eye = vec3(sin(yaw) * dist, dist * 0.6, cos(yaw) * dist);
+    vec3 f = normalize(-eye);
+    vec3 r = normalize(cross(f, vec3(0.0, 1.0, 0.0)));
+    vec3 u = cross(r, f);
+    vec3 rel = world - eye;
+    vec3 viewPos = vec3(dot(rel, r), dot(rel, u), -dot(rel, f));
+
+    // 透视投影：垂直视场 45 度
+    const float NEAR = 0.1;
+    const float FAR  = 100.0;
+    float fy = 1.0 / tan(radians(45.0) * 0.5);
+    float aspect = iResolution.x / max(iResolution.y, 1.0);
+    gl_Position = vec4(viewPos.x * fy / aspect,
+                       viewPos.y * fy,
+                       (viewPos.z * (FAR + NEAR) + 2.0 * FAR * NEAR) / (NEAR - FAR),
+                       -viewPos.z);
+
+    vNormal   = model * aNormal;
+    vWorldPos = world;
+}
@@ -0,0 +1,34 @@
+// ===== 距离预通道公共代码：由引擎注入到 #version 之后，不能单独编译 =====
+//
+// TR_PREPASS_WRITE  低分辨率通道。每个像素代表 iPrepassScale x iPrepassScale 的块，
+//                   场景沿块中心光线做锥形步进，把安全起始距离写入 fragColor.r
+// TR_PREPASS_READ   全分辨率通道。prepassStartDistance() 返回本像素所在块的起始距离
+//
+// 两个宏都未定义时场景按原样渲染，所以场景代码中的分支都需要用 #ifdef 包裹。
+
+#define TR_PREPASS 1
+
+uniform float iPrepassScale;
+#ifdef TR_PREPASS_READ
+uniform sampler2D iPrepass;
+#endif
+
+// 生成光线用的全分辨率像素坐标：预通道取块中心
+vec2 prepassFragCoord() {
+#ifdef TR_PREPASS_WRITE
+    return gl_FragCoord.xy * iPrepassScale;
+#else
+    return gl_FragCoord.xy;
+#endif
+}
+
+// 块中心到块角的距离（全分辨率像素），用于计算锥半径
+float prepassBlockRadius() {
+    return iPrepassScale * 0.70710678;
+}
+
+#ifdef TR_PREPASS_READ
+float prepassStartDistance() {
+    return texelFetch(iPrepass, ivec2(gl_FragCoord.xy / iPrepassScale), 0).r;
+}
+#endif
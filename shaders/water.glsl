@@ -34,6 +34,18 @@ mat3 fromEuler(vec3 ang) {
     m[2] = vec3(a3.y*a1.x*a2.x+a1.y*a3.x,a1.x*a3.x-a1.y*a3.y*a2.x,a2.y*a3.y);
     return m;
 }
+#ifdef USE_NOISE_LUT
+// 场景变体：iChannel0 为 value_noise 查找表（线性过滤、REPEAT）。
+// 采样点落在 i+u 处，硬件双线性插值一次完成 4 个格点的混合，+0.5 对齐纹素中心
+uniform sampler2D iChannel0;
+uniform vec3 iChannelResolution[4];
+float noise(in vec2 p) {
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+    vec2 u = f*f*(3.0-2.0*f);
+    return -1.0+2.0*textureLod(iChannel0,(i+u+0.5)/iChannelResolution[0].xy,0.0).x;
+}
+#else
 float hash(vec2 p) {
     float h = dot(p,vec2(127.1,311.7));
     return fract(sin(h)*43758.5453123);
@@ -45,6 +57,7 @@ float noise(in vec2 p) {
     return -1.0+2.0*mix(mix(hash(i+vec2(0.0,0.0)),hash(i+vec2(1.0,0.0)),u.x),
                         mix(hash(i+vec2(0.0,1.0)),hash(i+vec2(1.0,1.0)),u.x),u.y);
 }
+#endif
 
 float diffuse(vec3 n,vec3 l,float p) {
     return pow(dot(n,l)*0.4+0.6,p);
@@ -116,6 +129,12 @@ float heightMapTracing(vec3 ori,vec3 dir,out vec3 p) {
     float hx=map(ori+dir*tx);
     if(hx>0.0){ p=ori+dir*tx; return tx; }
     float hm=map(ori);
+#ifdef TR_PREPASS_READ
+    // 预通道起点仍在水面之上才收紧区间，否则保持从 0 开始
+    float ts=prepassStartDistance();
+    float hs=map(ori+dir*ts);
+    if(ts<tx && hs>0.0){ tm=ts; hm=hs; }
+#endif
     for(int i=0;i<NUM_STEPS;i++){
         float tmid=mix(tm,tx,hm/(hm-hx));
         p=ori+dir*tmid;
@@ -125,13 +144,17 @@ float heightMapTracing(vec3 ori,vec3 dir,out vec3 p) {
     }
     return mix(tm,tx,hm/(hm-hx));
 }
-vec3 getPixel(vec2 coord) {
+void getRay(vec2 coord,out vec3 ori,out vec3 dir) {
     vec2 uv=(coord*2.0-iResolution.xy)/min(iResolution.x,iResolution.y);
     float time=iTime*0.3+iMouse.x*0.01;
     vec3 ang=vec3(sin(time*3.0)*0.1,sin(time)*0.2+0.3,time);
-    vec3 ori=vec3(0.0,3.5,time*5.0);
-    vec3 dir=normalize(vec3(uv,-2.0)); dir.z+=length(uv)*0.14;
+    ori=vec3(0.0,3.5,time*5.0);
+    dir=normalize(vec3(uv,-2.0)); dir.z+=length(uv)*0.14;
     dir=normalize(dir)*fromEuler(ang);
+}
+vec3 getPixel(vec2 coord) {
+    vec3 ori,dir;
+    getRay(coord,ori,dir);
 
     vec3 p;
     heightMapTracing(ori,dir,p);
@@ -143,7 +166,31 @@ vec3 getPixel(vec2 coord) {
                pow(smoothstep(0.0,-0.02,dir.y),0.2));
 }
 
+#ifdef TR_PREPASS_WRITE
+// 高度场的保守步进：map() 为到水面的竖直高度，按波面坡度上限缩小步长，
+// 并扣除块内光线在该距离处的锥半径
+float coneTrace(vec3 ori,vec3 dir,float coneSlope) {
+    const float MAX_SLOPE=1.0;
+    float t=0.0;
+    for(int i=0;i<NUM_STEPS;i++){
+        float h=map(ori+dir*t)-t*coneSlope*(1.0+MAX_SLOPE);
+        if(h<EPSILON) break;
+        t+=h/(abs(dir.y)+MAX_SLOPE);
+        if(t>1000.0) break;
+    }
+    return t;
+}
+#endif
+
 void main() {
+#ifdef TR_PREPASS_WRITE
+    // uv 每像素 2/min(iResolution)，焦距 2.0
+    vec3 ori,dir;
+    getRay(prepassFragCoord(),ori,dir);
+    float coneSlope=prepassBlockRadius()/min(iResolution.x,iResolution.y);
+    fragColor=vec4(coneTrace(ori,dir,coneSlope),0.0,0.0,1.0);
+#else
     vec3 color = getPixel(gl_FragCoord.xy);
     fragColor  = vec4(pow(color, vec3(0.65)), 1.0);
+#endif
 }
\ No newline at end of file
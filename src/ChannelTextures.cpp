@@ -0,0 +1,60 @@
+#include "ChannelTextures.h"
+#include "NoiseLUT.h"
+#include <iostream>
+
+ChannelTextures::ChannelTextures(const std::vector<ChannelConfig>& channels) {
+    for (size_t i = 0; i < channels.size(); ++i) {
+        const ChannelConfig& config = channels[i];
+
+        LUTImage image = (config.type == "image")
+            ? NoiseLUT::loadImage(config.path)
+            : NoiseLUT::loadOrGenerate(kCacheDir, config.type, config.size, config.seed);
+
+        Channel channel;
+        channel.width = image.width;
+        channel.height = image.height;
+        channel.samplerName = "iChannel" + std::to_string(i);
+        channel.resolutionName = "iChannelResolution[" + std::to_string(i) + "]";
+
+        glGenTextures(1, &channel.texture);
+        glBindTexture(GL_TEXTURE_2D, channel.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+
+        GLint minFilter;
+        if (config.mipmaps) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+            minFilter = config.linearFilter ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+        } else {
+            minFilter = config.linearFilter ? GL_LINEAR : GL_NEAREST;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, config.linearFilter ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        textures.push_back(channel);
+        std::cout << "iChannel" << i << ": " << config.type << " " << image.width << "x" << image.height
+                  << (config.mipmaps ? " (mipmapped)" : "") << std::endl;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+ChannelTextures::~ChannelTextures() {
+    for (const auto& channel : textures) {
+        glDeleteTextures(1, &channel.texture);
+    }
+}
+
+void ChannelTextures::bind(Shader& shader) const {
+    for (size_t i = 0; i < textures.size(); ++i) {
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+        glBindTexture(GL_TEXTURE_2D, textures[i].texture);
+
+        shader.setInt(textures[i].samplerName, static_cast<int>(i));
+        shader.setVec3(textures[i].resolutionName,
+                       static_cast<float>(textures[i].width), static_cast<float>(textures[i].height), 1.0f);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
@@ -85,12 +85,120 @@ void Config::loadScenes(const YAML::Node& config) {
         scene.description = sceneNode["description"] ? sceneNode["description"].as<std::string>() : "";
         scene.vertexShader = sceneNode["vertex_shader"] ? sceneNode["vertex_shader"].as<std::string>() : "";
         scene.fragmentShader = sceneNode["fragment_shader"] ? sceneNode["fragment_shader"].as<std::string>() : "";
+        if (sceneNode["foveation"]) {
+            loadFoveationConfig(sceneNode["foveation"], scene.foveation);
+        }
+        if (sceneNode["prepass"]) {
+            loadPrepassConfig(sceneNode["prepass"], scene.prepass);
+        }
+        if (sceneNode["channels"]) {
+            loadChannelConfigs(sceneNode["channels"], scene.channels);
+        }
+        if (sceneNode["defines"]) {
+            const YAML::Node& definesNode = sceneNode["defines"];
+            for (size_t i = 0; i < definesNode.size(); ++i) {
+                scene.defines.push_back(definesNode[i].as<std::string>());
+            }
+        }
+        if (sceneNode["mesh"]) {
+            loadMeshConfig(sceneNode["mesh"], scene);
+        }
         
         scenes[sceneName] = scene;
         std::cout << "Loaded scene: " << sceneName << " (" << scene.name << ")" << std::endl;
     }
 }
 
+void Config::loadFoveationConfig(const YAML::Node& node, FoveationConfig& foveation) {
+    if (node["enabled"]) foveation.enabled = node["enabled"].as<bool>();
+    if (node["inner_radius"]) foveation.innerRadius = node["inner_radius"].as<float>();
+    if (node["outer_radius"]) foveation.outerRadius = node["outer_radius"].as<float>();
+    if (node["periphery_scale"]) foveation.peripheryScale = node["periphery_scale"].as<float>();
+    
+    // 过渡带不能为负，外围缩放限制在合理范围内
+    if (foveation.innerRadius < 0.0f) foveation.innerRadius = 0.0f;
+    if (foveation.outerRadius < foveation.innerRadius) {
+        std::cerr << "Warning: foveation outer_radius < inner_radius, clamped" << std::endl;
+        foveation.outerRadius = foveation.innerRadius;
+    }
+    if (foveation.peripheryScale <= 0.0f || foveation.peripheryScale > 1.0f) {
+        std::cerr << "Warning: foveation periphery_scale out of range (0, 1], using 0.5" << std::endl;
+        foveation.peripheryScale = 0.5f;
+    }
+}
+
+void Config::loadPrepassConfig(const YAML::Node& node, PrepassConfig& prepass) {
+    if (node["enabled"]) prepass.enabled = node["enabled"].as<bool>();
+    if (node["scale"]) prepass.scale = node["scale"].as<int>();
+    
+    if (prepass.scale < 2 || prepass.scale > 16) {
+        std::cerr << "Warning: prepass scale out of range [2, 16], using 4" << std::endl;
+        prepass.scale = 4;
+    }
+}
+
+void Config::loadChannelConfigs(const YAML::Node& node, std::vector<ChannelConfig>& channels) {
+    if (!node.IsSequence()) {
+        std::cerr << "Warning: scene channels must be a list, ignored" << std::endl;
+        return;
+    }
+    
+    for (size_t i = 0; i < node.size(); ++i) {
+        if (i >= 4) {
+            std::cerr << "Warning: only iChannel0..3 are supported, extra channels ignored" << std::endl;
+            break;
+        }
+        
+        const YAML::Node& channelNode = node[i];
+        ChannelConfig channel;
+        if (channelNode["type"]) channel.type = channelNode["type"].as<std::string>();
+        if (channelNode["path"]) channel.path = channelNode["path"].as<std::string>();
+        if (channelNode["size"]) channel.size = channelNode["size"].as<int>();
+        if (channelNode["seed"]) channel.seed = channelNode["seed"].as<unsigned int>();
+        if (channelNode["mipmaps"]) channel.mipmaps = channelNode["mipmaps"].as<bool>();
+        if (channelNode["filter"]) channel.linearFilter = channelNode["filter"].as<std::string>() != "nearest";
+        
+        if (channel.type == "image" && channel.path.empty()) {
+            throw std::runtime_error("iChannel" + std::to_string(i) + ": image channel requires a path");
+        }
+        if (channel.type != "image" && channel.type != "value_noise" &&
+            channel.type != "perlin_noise" && channel.type != "blue_noise") {
+            throw std::runtime_error("iChannel" + std::to_string(i) + ": unknown type '" + channel.type + "'");
+        }
+        if (channel.size < 4 || channel.size > 4096) {
+            std::cerr << "Warning: iChannel" << i << " size out of range [4, 4096], using 256" << std::endl;
+            channel.size = 256;
+        }
+        // 蓝噪声生成是逐点串行的，限制尺寸以免首次启动时间过长
+        if (channel.type == "blue_noise" && channel.size > 512) {
+            std::cerr << "Warning: iChannel" << i << " blue_noise size limited to 512, using 512" << std::endl;
+            channel.size = 512;
+        }
+        channels.push_back(channel);
+    }
+}
+
+void Config::loadMeshConfig(const YAML::Node& node, ShaderScene& scene) {
+    MeshConfig& mesh = scene.mesh;
+    if (node["path"]) mesh.path = node["path"].as<std::string>();
+    if (node["instances"]) mesh.instances = node["instances"].as<int>();
+    
+    if (mesh.path.empty()) {
+        throw std::runtime_error("Scene mesh requires a path");
+    }
+    if (mesh.instances < 1) {
+        std::cerr << "Warning: mesh instances must be >= 1, using 1" << std::endl;
+        mesh.instances = 1;
+    }
+    
+    // 注视点渲染与距离预通道只针对全屏着色器，离屏目标也没有深度缓冲
+    if (scene.foveation.enabled || scene.prepass.enabled) {
+        std::cerr << "Warning: foveation/prepass are not supported for mesh scenes, disabled" << std::endl;
+        scene.foveation.enabled = false;
+        scene.prepass.enabled = false;
+    }
+}
+
 void Config::loadWindowConfig(const YAML::Node& config) {
     if (!config["window"]) {
         return;
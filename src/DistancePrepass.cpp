@@ -0,0 +1,122 @@
+#include "DistancePrepass.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+DistancePrepass::DistancePrepass(const ShaderScene& scene)
+    : scale(scene.prepass.scale),
+      prepassShader(scene.vertexShader, scene.fragmentShader, prepassDefines(scene), kPreludePath) {
+    prepassShader.setupQuad();
+    std::cout << "Distance prepass enabled (1/" << scale << " resolution)" << std::endl;
+}
+
+std::vector<std::string> DistancePrepass::prepassDefines(const ShaderScene& scene) {
+    // 场景自身的变体宏在前，保证预通道与全分辨率通道编译出同一个场景
+    std::vector<std::string> defines = scene.defines;
+    defines.push_back(kWriteDefine);
+    return defines;
+}
+
+DistancePrepass::~DistancePrepass() {
+    for (const Target& target : targets) {
+        destroyTarget(target);
+    }
+}
+
+DistancePrepass::Target DistancePrepass::createTarget(int width, int height) {
+    Target target = {0, 0, width, height};
+
+    // 单通道浮点纹理，按块读取，不需要过滤
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        destroyTarget(target);
+        throw std::runtime_error("Distance prepass target is incomplete");
+    }
+    return target;
+}
+
+void DistancePrepass::destroyTarget(const Target& target) {
+    if (target.fbo != 0) glDeleteFramebuffers(1, &target.fbo);
+    if (target.texture != 0) glDeleteTextures(1, &target.texture);
+}
+
+const DistancePrepass::Target& DistancePrepass::acquireTarget(int width, int height) {
+    auto it = std::find_if(targets.begin(), targets.end(), [&](const Target& target) {
+        return target.width == width && target.height == height;
+    });
+    if (it != targets.end()) {
+        std::rotate(targets.begin(), it, it + 1);
+        return targets.front();
+    }
+
+    // 没有匹配尺寸（首次运行或窗口缩放）：淘汰最久未用的目标
+    if (targets.size() >= kMaxTargets) {
+        destroyTarget(targets.back());
+        targets.pop_back();
+    }
+    targets.insert(targets.begin(), createTarget(width, height));
+    return targets.front();
+}
+
+void DistancePrepass::run(int width, int height, const SetUniformsFn& setUniforms) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // 保存调用方的渲染状态（注视点渲染会在离屏目标和裁剪区域内调用）
+    GLint previousFBO;
+    GLint previousViewport[4];
+    GLint previousScissor[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFBO);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetIntegerv(GL_SCISSOR_BOX, previousScissor);
+    GLboolean scissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+
+    // 块数向上取整，保证覆盖边缘不完整的块
+    int blocksX = (width + scale - 1) / scale;
+    int blocksY = (height + scale - 1) / scale;
+    const Target& target = acquireTarget(blocksX, blocksY);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glViewport(0, 0, target.width, target.height);
+    if (scissorEnabled) {
+        // 裁剪框换算到块坐标并向外取整，只步进全分辨率通道会读取的块
+        int x0 = previousScissor[0] / scale;
+        int y0 = previousScissor[1] / scale;
+        int x1 = (previousScissor[0] + previousScissor[2] + scale - 1) / scale;
+        int y1 = (previousScissor[1] + previousScissor[3] + scale - 1) / scale;
+        glScissor(x0, y0, x1 - x0, y1 - y0);
+    }
+
+    // iResolution 使用全分辨率，使预通道与全分辨率通道的相机完全一致
+    prepassShader.use();
+    glBindVertexArray(prepassShader.getVAO());
+    setUniforms(prepassShader, width, height);
+    prepassShader.setFloat("iPrepassScale", static_cast<float>(scale));
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    if (scissorEnabled) {
+        glScissor(previousScissor[0], previousScissor[1], previousScissor[2], previousScissor[3]);
+    }
+}
+
+void DistancePrepass::bind(Shader& sceneShader) const {
+    glActiveTexture(GL_TEXTURE0 + kTextureUnit);
+    glBindTexture(GL_TEXTURE_2D, targets.empty() ? 0 : targets.front().texture);
+    glActiveTexture(GL_TEXTURE0);
+
+    sceneShader.setInt("iPrepass", static_cast<int>(kTextureUnit));
+    sceneShader.setFloat("iPrepassScale", static_cast<float>(scale));
+}
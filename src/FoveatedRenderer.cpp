@@ -0,0 +1,118 @@
+#include "FoveatedRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+FoveatedRenderer::FoveatedRenderer(const FoveationConfig& config)
+    : config(config),
+      compositeShader("shaders/vertex.glsl", "shaders/foveated_composite.glsl", true),
+      peripheryFBO(0), peripheryTexture(0), foveaFBO(0), foveaTexture(0),
+      targetWidth(0), targetHeight(0), peripheryWidth(0), peripheryHeight(0) {
+    compositeShader.setupQuad();
+
+    // 纹理单元固定：0=外围，1=注视区
+    compositeShader.use();
+    compositeShader.setInt("iPeriphery", 0);
+    compositeShader.setInt("iFovea", 1);
+
+    std::cout << "Foveated rendering enabled (inner: " << config.innerRadius
+              << ", outer: " << config.outerRadius
+              << ", periphery scale: " << config.peripheryScale << ")" << std::endl;
+}
+
+FoveatedRenderer::~FoveatedRenderer() {
+    destroyTargets();
+}
+
+void FoveatedRenderer::createTarget(GLuint& fbo, GLuint& texture, int width, int height, GLenum filter) {
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("Foveated render target is incomplete");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void FoveatedRenderer::destroyTargets() {
+    if (peripheryFBO != 0) glDeleteFramebuffers(1, &peripheryFBO);
+    if (peripheryTexture != 0) glDeleteTextures(1, &peripheryTexture);
+    if (foveaFBO != 0) glDeleteFramebuffers(1, &foveaFBO);
+    if (foveaTexture != 0) glDeleteTextures(1, &foveaTexture);
+    peripheryFBO = peripheryTexture = foveaFBO = foveaTexture = 0;
+}
+
+void FoveatedRenderer::resize(int width, int height) {
+    destroyTargets();
+
+    targetWidth = width;
+    targetHeight = height;
+    peripheryWidth = std::max(1, static_cast<int>(width * config.peripheryScale));
+    peripheryHeight = std::max(1, static_cast<int>(height * config.peripheryScale));
+
+    // 外围纹理线性过滤，合成时放大即为平滑插值；注视区按像素直接读取
+    createTarget(peripheryFBO, peripheryTexture, peripheryWidth, peripheryHeight, GL_LINEAR);
+    createTarget(foveaFBO, foveaTexture, width, height, GL_NEAREST);
+
+    std::cout << "Foveation targets: " << width << "x" << height
+              << " (periphery " << peripheryWidth << "x" << peripheryHeight << ")" << std::endl;
+}
+
+void FoveatedRenderer::render(int width, int height, float cursorX, float cursorY, const DrawSceneFn& drawScene) {
+    if (width <= 0 || height <= 0) {
+        return;  // 窗口最小化
+    }
+    if (width != targetWidth || height != targetHeight) {
+        resize(width, height);
+    }
+
+    float innerPx = config.innerRadius * height;
+    float outerPx = std::max(config.outerRadius * height, innerPx + 1.0f);  // smoothstep 要求 edge0 < edge1
+
+    // 1. 外围：整幅画面低分辨率渲染
+    glBindFramebuffer(GL_FRAMEBUFFER, peripheryFBO);
+    glViewport(0, 0, peripheryWidth, peripheryHeight);
+    drawScene(peripheryWidth, peripheryHeight);
+
+    // 2. 注视区：全分辨率，只着色外半径包围盒内的像素
+    int x0 = std::max(0, static_cast<int>(std::floor(cursorX - outerPx)));
+    int y0 = std::max(0, static_cast<int>(std::floor(cursorY - outerPx)));
+    int x1 = std::min(width, static_cast<int>(std::ceil(cursorX + outerPx)));
+    int y1 = std::min(height, static_cast<int>(std::ceil(cursorY + outerPx)));
+    if (x1 > x0 && y1 > y0) {
+        glBindFramebuffer(GL_FRAMEBUFFER, foveaFBO);
+        glViewport(0, 0, width, height);
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x0, y0, x1 - x0, y1 - y0);
+        drawScene(width, height);
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    // 3. 合成：按到鼠标的距离在两者间平滑过渡
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, peripheryTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, foveaTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    compositeShader.use();
+    compositeShader.setVec2("iResolution", static_cast<float>(width), static_cast<float>(height));
+    compositeShader.setVec2("iCursor", cursorX, cursorY);
+    compositeShader.setFloat("iInnerRadius", innerPx);
+    compositeShader.setFloat("iOuterRadius", outerPx);
+
+    glBindVertexArray(compositeShader.getVAO());
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
@@ -0,0 +1,49 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path)
+    : mapping(nullptr), length(0), mtime(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to stat file: " + path);
+    }
+    length = static_cast<size_t>(info.st_size);
+    // st_mtime 只有秒级精度，同一秒内重新导出的同尺寸文件会被误判为未变化
+    mtime = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+
+    // 空文件无法映射，保持 data() == nullptr
+    if (length > 0) {
+        void* result = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (result == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed to mmap file: " + path);
+        }
+        mapping = result;
+    }
+
+    // 映射建立后即可关闭文件描述符
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (mapping) {
+        munmap(mapping, length);
+    }
+}
+
+void MappedFile::adviseSequential() const {
+    if (mapping) {
+        madvise(mapping, length, MADV_SEQUENTIAL);
+        madvise(mapping, length, MADV_WILLNEED);
+    }
+}
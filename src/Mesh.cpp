@@ -0,0 +1,85 @@
+#include "Mesh.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+Mesh::Mesh(const MeshConfig& config)
+    : vao(0), vbo(0), ebo(0), immutableStorage(false), indexCount(0),
+      instanceCount(config.instances), center{0.0f, 0.0f, 0.0f}, radius(1.0f) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::string meshPath = MeshCache::prepare(config.path, kCacheDir);
+    MappedFile file(meshPath);
+    file.adviseSequential();
+    MeshView view = MeshCache::view(file);
+    upload(view);
+
+    // 包围盒中心与半径，顶点着色器据此把任意尺寸的资源归一化到单位球
+    const MeshFileHeader& header = *view.header;
+    float extent = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+        center[k] = 0.5f * (header.boundsMin[k] + header.boundsMax[k]);
+        float half = 0.5f * (header.boundsMax[k] - header.boundsMin[k]);
+        extent += half * half;
+    }
+    radius = std::max(std::sqrt(extent), 1e-6f);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Mesh loaded: " << config.path << " (" << header.vertexCount << " vertices, "
+              << header.indexCount / 3 << " triangles, " << instanceCount << " instances) in "
+              << ms << "ms" << (immutableStorage ? " [immutable storage]" : "") << std::endl;
+}
+
+Mesh::~Mesh() {
+    if (vao != 0) glDeleteVertexArrays(1, &vao);
+    if (vbo != 0) glDeleteBuffers(1, &vbo);
+    if (ebo != 0) glDeleteBuffers(1, &ebo);
+}
+
+void Mesh::createBuffer(GLenum target, GLuint& buffer, const void* source, size_t bytes) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+    GLsizeiptr size = static_cast<GLsizeiptr>(bytes);
+
+    // 数据只在加载时写入一次：source 指向映射的 .trmesh，驱动直接从页缓存读取
+    if (immutableStorage) {
+        // 不可变存储，flags 为 0 表示之后 CPU 不再访问，驱动可放在显存中
+        glBufferStorage(target, size, source, 0);
+    } else {
+        // 不支持 ARB_buffer_storage（例如 OpenGL 4.1）时使用普通静态缓冲
+        glBufferData(target, size, source, GL_STATIC_DRAW);
+    }
+}
+
+void Mesh::upload(const MeshView& view) {
+    immutableStorage = GLEW_ARB_buffer_storage;
+    indexCount = static_cast<GLsizei>(view.header->indexCount);
+
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    createBuffer(GL_ARRAY_BUFFER, vbo, view.vertices, view.header->vertexCount * sizeof(MeshVertex));
+    // 索引缓冲绑定记录在 VAO 中
+    createBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo, view.indices, view.header->indexCount * sizeof(uint32_t));
+
+    // 交错布局：location 0 = 位置，location 1 = 法线
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<void*>(offsetof(MeshVertex, position)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<void*>(offsetof(MeshVertex, normal)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+}
+
+void Mesh::draw(Shader& shader) const {
+    shader.setVec3("iMeshCenter", center[0], center[1], center[2]);
+    shader.setFloat("iMeshRadius", radius);
+    shader.setInt("iInstanceCount", instanceCount);
+
+    glBindVertexArray(vao);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+}
@@ -0,0 +1,359 @@
+#include "MeshCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const char kMeshMagic[4] = {'T', 'R', 'M', 'S'};
+const uint32_t kMeshVersion = 1;
+static_assert(sizeof(MeshFileHeader) == 56, "MeshFileHeader layout is part of the cache format");
+static_assert(sizeof(MeshVertex) == 24, "MeshVertex layout is part of the cache format");
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool hasSuffix(const std::string& value, const std::string& suffix) {
+    return value.size() >= suffix.size() &&
+           value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void skipBlanks(const char*& p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+}
+
+void skipLine(const char*& p, const char* end) {
+    while (p < end && *p != '\n') ++p;
+    if (p < end) ++p;
+}
+
+// 映射内存不保证以 '\0' 结尾，不能用 strtof，这里按 end 做边界检查
+bool parseFloat(const char*& p, const char* end, float& out) {
+    skipBlanks(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    double value = 0.0;
+    bool hasDigits = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10.0 + (*p - '0');
+        hasDigits = true;
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value += (*p - '0') * scale;
+            scale *= 0.1;
+            hasDigits = true;
+            ++p;
+        }
+    }
+    if (!hasDigits) {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExp = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExp = (*p == '-');
+            ++p;
+        }
+        int exponent = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            exponent = exponent * 10 + (*p - '0');
+            ++p;
+        }
+        value *= std::pow(10.0, negativeExp ? -exponent : exponent);
+    }
+
+    out = static_cast<float>(negative ? -value : value);
+    return true;
+}
+
+bool parseInt(const char*& p, const char* end, long& out) {
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    if (p >= end || *p < '0' || *p > '9') {
+        return false;
+    }
+    long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        ++p;
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+// OBJ 索引从 1 开始，负数表示从末尾倒数；无效返回 -1
+long resolveIndex(long index, size_t count) {
+    long resolved = index > 0 ? index - 1 : static_cast<long>(count) + index;
+    return (resolved >= 0 && resolved < static_cast<long>(count)) ? resolved : -1;
+}
+
+} // namespace
+
+namespace MeshCache {
+
+std::string prepare(const std::string& sourcePath, const std::string& cacheDir) {
+    if (hasSuffix(sourcePath, ".trmesh")) {
+        return sourcePath;
+    }
+    if (!hasSuffix(sourcePath, ".obj")) {
+        throw std::runtime_error("Unsupported mesh format (.obj / .trmesh only): " + sourcePath);
+    }
+
+    // 缓存文件名带上源路径的哈希，避免不同目录的同名资源冲突
+    std::filesystem::path source(sourcePath);
+    std::string cachePath = cacheDir + "/" + source.stem().string() + "_" +
+                            std::to_string(std::hash<std::string>{}(sourcePath)) + ".trmesh";
+
+    MappedFile obj(sourcePath);  // 映射是惰性的，只看大小和时间时不会读入内容
+    std::error_code ec;
+    if (std::filesystem::exists(cachePath, ec)) {
+        MappedFile cache(cachePath);
+        if (cache.size() >= sizeof(MeshFileHeader)) {
+            const auto* header = reinterpret_cast<const MeshFileHeader*>(cache.data());
+            if (std::memcmp(header->magic, kMeshMagic, 4) == 0 && header->version == kMeshVersion &&
+                header->sourceSize == obj.size() && header->sourceMtime == obj.modifiedTime()) {
+                return cachePath;
+            }
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    convertObj(obj, cachePath);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Converted mesh " << sourcePath << " -> " << cachePath << " in " << ms << "ms" << std::endl;
+    return cachePath;
+}
+
+void convertObj(const MappedFile& obj, const std::string& outPath) {
+    const char* begin = obj.data();
+    const char* end = begin + obj.size();
+
+    // 第一遍只数行，预留容量，避免百万级网格转换时反复扩容
+    size_t positionLines = 0, normalLines = 0, faceLines = 0;
+    for (const char* p = begin; p < end; skipLine(p, end)) {
+        skipBlanks(p, end);
+        if (end - p >= 2 && p[0] == 'v' && isBlank(p[1])) positionLines++;
+        else if (end - p >= 3 && p[0] == 'v' && p[1] == 'n' && isBlank(p[2])) normalLines++;
+        else if (end - p >= 2 && p[0] == 'f' && isBlank(p[1])) faceLines++;
+    }
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    positions.reserve(positionLines * 3);
+    normals.reserve(normalLines * 3);
+
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<bool> needsNormal;  // 源文件没有给出法线的顶点，稍后用面法线累加
+    vertices.reserve(positionLines);
+    indices.reserve(faceLines * 3);
+    needsNormal.reserve(positionLines);
+
+    // (位置索引, 法线索引) -> 输出顶点，相同组合只输出一次
+    std::unordered_map<uint64_t, uint32_t> vertexLookup;
+    vertexLookup.reserve(positionLines * 2);
+
+    auto emitVertex = [&](long positionIndex, long normalIndex) -> uint32_t {
+        uint64_t key = (static_cast<uint64_t>(positionIndex) << 32) | static_cast<uint32_t>(normalIndex);
+        auto it = vertexLookup.find(key);
+        if (it != vertexLookup.end()) {
+            return it->second;
+        }
+        MeshVertex vertex;
+        std::memcpy(vertex.position, &positions[positionIndex * 3], sizeof(vertex.position));
+        if (normalIndex >= 0) {
+            std::memcpy(vertex.normal, &normals[normalIndex * 3], sizeof(vertex.normal));
+        } else {
+            vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+        }
+        uint32_t index = static_cast<uint32_t>(vertices.size());
+        vertices.push_back(vertex);
+        needsNormal.push_back(normalIndex < 0);
+        vertexLookup.emplace(key, index);
+        return index;
+    };
+
+    std::vector<uint32_t> polygon;
+    size_t lineNumber = 0;
+    for (const char* p = begin; p < end; skipLine(p, end)) {
+        lineNumber++;
+        skipBlanks(p, end);
+        if (end - p >= 2 && p[0] == 'v' && isBlank(p[1])) {
+            p += 1;
+            float x, y, z;
+            if (!parseFloat(p, end, x) || !parseFloat(p, end, y) || !parseFloat(p, end, z)) {
+                throw std::runtime_error("Malformed vertex at OBJ line " + std::to_string(lineNumber));
+            }
+            positions.insert(positions.end(), {x, y, z});
+        } else if (end - p >= 3 && p[0] == 'v' && p[1] == 'n' && isBlank(p[2])) {
+            p += 2;
+            float x, y, z;
+            if (!parseFloat(p, end, x) || !parseFloat(p, end, y) || !parseFloat(p, end, z)) {
+                throw std::runtime_error("Malformed normal at OBJ line " + std::to_string(lineNumber));
+            }
+            normals.insert(normals.end(), {x, y, z});
+        } else if (end - p >= 2 && p[0] == 'f' && isBlank(p[1])) {
+            p += 1;
+            polygon.clear();
+            while (true) {
+                skipBlanks(p, end);
+                long vi, ti = 0, ni = 0;
+                if (!parseInt(p, end, vi)) break;
+                // v, v/vt, v//vn, v/vt/vn；纹理坐标不进入当前顶点布局
+                if (p < end && *p == '/') {
+                    ++p;
+                    parseInt(p, end, ti);
+                    if (p < end && *p == '/') {
+                        ++p;
+                        parseInt(p, end, ni);
+                    }
+                }
+                long positionIndex = resolveIndex(vi, positions.size() / 3);
+                long normalIndex = ni != 0 ? resolveIndex(ni, normals.size() / 3) : -1;
+                if (positionIndex < 0 || (ni != 0 && normalIndex < 0)) {
+                    throw std::runtime_error("Index out of range at OBJ line " + std::to_string(lineNumber));
+                }
+                polygon.push_back(emitVertex(positionIndex, normalIndex));
+            }
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                indices.insert(indices.end(), {polygon[0], polygon[i - 1], polygon[i]});
+            }
+        }
+    }
+
+    if (indices.empty()) {
+        throw std::runtime_error("OBJ contains no faces");
+    }
+
+    // 缺失的法线：按面积加权累加面法线后归一化
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const float* a = vertices[indices[i]].position;
+        const float* b = vertices[indices[i + 1]].position;
+        const float* c = vertices[indices[i + 2]].position;
+        float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = indices[i + k];
+            if (needsNormal[v]) {
+                vertices[v].normal[0] += n[0];
+                vertices[v].normal[1] += n[1];
+                vertices[v].normal[2] += n[2];
+            }
+        }
+    }
+
+    MeshFileHeader header;
+    std::memcpy(header.magic, kMeshMagic, 4);
+    header.version = kMeshVersion;
+    header.sourceSize = obj.size();
+    header.sourceMtime = obj.modifiedTime();
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    for (int k = 0; k < 3; ++k) {
+        header.boundsMin[k] = vertices[0].position[k];
+        header.boundsMax[k] = vertices[0].position[k];
+    }
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        MeshVertex& vertex = vertices[v];
+        if (needsNormal[v]) {
+            float length = std::sqrt(vertex.normal[0] * vertex.normal[0] + vertex.normal[1] * vertex.normal[1] +
+                                     vertex.normal[2] * vertex.normal[2]);
+            if (length > 0.0f) {
+                for (float& component : vertex.normal) component /= length;
+            } else {
+                vertex.normal[1] = 1.0f;
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            header.boundsMin[k] = std::min(header.boundsMin[k], vertex.position[k]);
+            header.boundsMax[k] = std::max(header.boundsMax[k], vertex.position[k]);
+        }
+    }
+
+    // 先写临时文件再改名，避免中断时留下半个缓存
+    std::error_code ec;
+    std::filesystem::path target(outPath);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+    std::string tmpPath = outPath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to write mesh cache: " + tmpPath);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(vertices.data()),
+                   static_cast<std::streamsize>(vertices.size() * sizeof(MeshVertex)));
+        file.write(reinterpret_cast<const char*>(indices.data()),
+                   static_cast<std::streamsize>(indices.size() * sizeof(uint32_t)));
+        if (!file) {
+            throw std::runtime_error("Failed to write mesh cache: " + tmpPath);
+        }
+    }
+    std::filesystem::rename(tmpPath, target, ec);
+    if (ec) {
+        throw std::runtime_error("Failed to write mesh cache: " + outPath);
+    }
+}
+
+MeshView view(const MappedFile& file) {
+    if (file.size() < sizeof(MeshFileHeader)) {
+        throw std::runtime_error("Mesh file is truncated");
+    }
+
+    MeshView result;
+    result.header = reinterpret_cast<const MeshFileHeader*>(file.data());
+    if (std::memcmp(result.header->magic, kMeshMagic, 4) != 0 || result.header->version != kMeshVersion) {
+        throw std::runtime_error("Not a Tiny Rasterizer mesh file (or version mismatch)");
+    }
+
+    size_t vertexBytes = static_cast<size_t>(result.header->vertexCount) * sizeof(MeshVertex);
+    size_t indexBytes = static_cast<size_t>(result.header->indexCount) * sizeof(uint32_t);
+    if (file.size() < sizeof(MeshFileHeader) + vertexBytes + indexBytes) {
+        throw std::runtime_error("Mesh file is truncated");
+    }
+
+    // 文件头 56 字节、顶点 24 字节，映射起始按页对齐，故两段数据都满足 4 字节对齐
+    result.vertices = reinterpret_cast<const MeshVertex*>(file.data() + sizeof(MeshFileHeader));
+    result.indices = reinterpret_cast<const uint32_t*>(file.data() + sizeof(MeshFileHeader) + vertexBytes);
+
+    // .trmesh 可以在配置中直接引用而不经过转换，越界索引会让 GPU 读到缓冲之外，加载时检查一遍
+    if (result.header->indexCount % 3 != 0) {
+        throw std::runtime_error("Mesh index count is not a multiple of 3");
+    }
+    const uint32_t vertexCount = result.header->vertexCount;
+    uint32_t maxIndex = 0;
+    for (uint32_t i = 0; i < result.header->indexCount; ++i) {
+        maxIndex = std::max(maxIndex, result.indices[i]);
+    }
+    if (result.header->indexCount > 0 && maxIndex >= vertexCount) {
+        throw std::runtime_error("Mesh index " + std::to_string(maxIndex) + " out of range (" +
+                                 std::to_string(vertexCount) + " vertices)");
+    }
+    return result;
+}
+
+} // namespace MeshCache
@@ -0,0 +1,379 @@
+#include "NoiseLUT.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// 缓存文件头，格式变化时递增版本号使旧缓存失效
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+};
+const char kCacheMagic[4] = {'T', 'R', 'L', 'T'};
+const uint32_t kCacheVersion = 2;
+
+uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+uint32_t hash3(uint32_t x, uint32_t y, uint32_t z) {
+    return hash32(x ^ hash32(y ^ hash32(z)));
+}
+
+// 把 [0, count) 按交错方式分给所有硬件线程
+template <typename Fn>
+void parallelFor(int count, Fn fn) {
+    unsigned int workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = std::min(workers, static_cast<unsigned int>(std::max(count, 1)));
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (unsigned int w = 0; w < workers; ++w) {
+        threads.emplace_back([&fn, w, workers, count]() {
+            for (int i = static_cast<int>(w); i < count; i += static_cast<int>(workers)) {
+                fn(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+LUTImage makeImage(int size) {
+    if (size <= 0) {
+        throw std::runtime_error("Invalid LUT size: " + std::to_string(size));
+    }
+    LUTImage image;
+    image.width = size;
+    image.height = size;
+    image.pixels.resize(static_cast<size_t>(size) * size * 4);
+    return image;
+}
+
+// 周期为 period 的二维梯度噪声，返回值约在 [-1, 1]
+float perlin(float x, float y, int period, uint32_t seed) {
+    int x0 = static_cast<int>(std::floor(x));
+    int y0 = static_cast<int>(std::floor(y));
+    float fx = x - x0;
+    float fy = y - y0;
+
+    auto gradientDot = [&](int ix, int iy, float dx, float dy) {
+        uint32_t h = hash3(static_cast<uint32_t>(((ix % period) + period) % period),
+                           static_cast<uint32_t>(((iy % period) + period) % period), seed);
+        float angle = (h & 0xffff) * (6.28318530f / 65536.0f);
+        return std::cos(angle) * dx + std::sin(angle) * dy;
+    };
+    auto fade = [](float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); };
+
+    float n00 = gradientDot(x0, y0, fx, fy);
+    float n10 = gradientDot(x0 + 1, y0, fx - 1.0f, fy);
+    float n01 = gradientDot(x0, y0 + 1, fx, fy - 1.0f);
+    float n11 = gradientDot(x0 + 1, y0 + 1, fx - 1.0f, fy - 1.0f);
+    float u = fade(fx);
+    float v = fade(fy);
+    float nx0 = n00 + (n10 - n00) * u;
+    float nx1 = n01 + (n11 - n01) * u;
+    return (nx0 + (nx1 - nx0) * v) * 1.41421356f;
+}
+
+// 以能量为键的索引最小堆：记录每个元素在堆中的位置，能量增加后可以原地下沉
+class EnergyHeap {
+public:
+    explicit EnergyHeap(const std::vector<float>& energy)
+        : energy(energy), heap(energy.size()), position(energy.size()) {
+        for (size_t i = 0; i < heap.size(); ++i) {
+            heap[i] = static_cast<int>(i);
+            position[i] = static_cast<int>(i);
+        }
+        for (size_t i = heap.size() / 2; i-- > 0;) {
+            siftDown(i);
+        }
+    }
+
+    bool contains(int element) const { return position[element] >= 0; }
+
+    // 取出能量最低的元素
+    int pop() {
+        int top = heap[0];
+        moveTo(heap.back(), 0);
+        heap.pop_back();
+        position[top] = -1;
+        if (!heap.empty()) {
+            siftDown(0);
+        }
+        return top;
+    }
+
+    // 元素能量只会增加，下沉即可恢复堆序
+    void increased(int element) { siftDown(static_cast<size_t>(position[element])); }
+
+private:
+    const std::vector<float>& energy;
+    std::vector<int> heap;
+    std::vector<int> position;  // 元素 -> 堆下标，已取出为 -1
+
+    void moveTo(int element, size_t slot) {
+        heap[slot] = element;
+        position[element] = static_cast<int>(slot);
+    }
+
+    void siftDown(size_t slot) {
+        int element = heap[slot];
+        const size_t count = heap.size();
+        for (;;) {
+            size_t child = slot * 2 + 1;
+            if (child >= count) break;
+            if (child + 1 < count && energy[heap[child + 1]] < energy[heap[child]]) ++child;
+            if (energy[heap[child]] >= energy[element]) break;
+            moveTo(heap[child], slot);
+            slot = child;
+        }
+        moveTo(element, slot);
+    }
+};
+
+// 简化 void-and-cluster：依次在能量最低（最空）的位置放点，放置顺序即阈值
+// 空位按能量放在索引堆中，每放一个点只更新核覆盖的 k² 个位置，总代价 O(N·k²·log N)
+void blueNoiseChannel(int size, uint32_t seed, uint8_t* out) {
+    const int count = size * size;
+    const float sigma = 1.5f;
+    const int radius = std::min(size / 2 - 1, 5);
+
+    // 截断的高斯核，环绕寻址保证可平铺
+    const int kernelWidth = 2 * radius + 1;
+    std::vector<float> kernel(static_cast<size_t>(kernelWidth) * kernelWidth);
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            kernel[(dy + radius) * kernelWidth + (dx + radius)] =
+                std::exp(-(dx * dx + dy * dy) / (2.0f * sigma * sigma));
+        }
+    }
+
+    // 微小随机扰动用于打破并列，避免规则图案
+    std::vector<float> energy(count);
+    for (int i = 0; i < count; ++i) {
+        energy[i] = (hash3(static_cast<uint32_t>(i), seed, 0x9e3779b9U) & 0xffff) * 1e-9f;
+    }
+    EnergyHeap empty(energy);
+
+    for (int rank = 0; rank < count; ++rank) {
+        int best = empty.pop();
+        out[static_cast<size_t>(best) * 4] = static_cast<uint8_t>((static_cast<int64_t>(rank) * 256) / count);
+
+        int bx = best % size;
+        int by = best / size;
+        for (int dy = -radius; dy <= radius; ++dy) {
+            int y = (by + dy + size) % size;
+            for (int dx = -radius; dx <= radius; ++dx) {
+                int x = (bx + dx + size) % size;
+                int i = y * size + x;
+                energy[i] += kernel[(dy + radius) * kernelWidth + (dx + radius)];
+                if (empty.contains(i)) {
+                    empty.increased(i);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+namespace NoiseLUT {
+
+LUTImage generateValueNoise(int size, uint32_t seed) {
+    LUTImage image = makeImage(size);
+    parallelFor(size, [&](int y) {
+        uint8_t* row = image.pixels.data() + static_cast<size_t>(y) * size * 4;
+        for (int x = 0; x < size; ++x) {
+            uint32_t h = hash3(static_cast<uint32_t>(x), static_cast<uint32_t>(y), seed);
+            std::memcpy(row + x * 4, &h, 4);
+        }
+    });
+    return image;
+}
+
+LUTImage generatePerlinNoise(int size, uint32_t seed) {
+    LUTImage image = makeImage(size);
+    parallelFor(size, [&](int y) {
+        uint8_t* row = image.pixels.data() + static_cast<size_t>(y) * size * 4;
+        for (int x = 0; x < size; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                int period = 4 << c;
+                float scale = static_cast<float>(period) / size;
+                float n = perlin(x * scale, y * scale, period, seed + static_cast<uint32_t>(c));
+                float value = std::min(std::max(n * 0.5f + 0.5f, 0.0f), 1.0f);
+                row[x * 4 + c] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+            }
+        }
+    });
+    return image;
+}
+
+LUTImage generateBlueNoise(int size, uint32_t seed) {
+    if (size < 4) {
+        throw std::runtime_error("Blue noise LUT size must be at least 4");
+    }
+    LUTImage image = makeImage(size);
+    // 排序过程本身是串行的，4 个通道互相独立，各用一个线程
+    parallelFor(4, [&](int c) {
+        blueNoiseChannel(size, seed + static_cast<uint32_t>(c) * 0x68bc21ebU, image.pixels.data() + c);
+    });
+    return image;
+}
+
+LUTImage generate(const std::string& type, int size, uint32_t seed) {
+    if (type == "value_noise") return generateValueNoise(size, seed);
+    if (type == "perlin_noise") return generatePerlinNoise(size, seed);
+    if (type == "blue_noise") return generateBlueNoise(size, seed);
+    throw std::runtime_error("Unknown LUT type: " + type);
+}
+
+LUTImage loadOrGenerate(const std::string& cacheDir, const std::string& type, int size, uint32_t seed) {
+    std::string path = cacheDir + "/" + type + "_" + std::to_string(size) + "_" + std::to_string(seed) + ".lut";
+
+    LUTImage image;
+    if (readCache(path, image) && image.width == size && image.height == size) {
+        std::cout << "Loaded cached LUT: " << path << std::endl;
+        return image;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    image = generate(type, size, seed);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Generated LUT " << type << " " << size << "x" << size << " in " << ms << "ms" << std::endl;
+
+    if (!writeCache(path, image)) {
+        std::cerr << "Warning: failed to write LUT cache: " << path << std::endl;
+    }
+    return image;
+}
+
+bool readCache(const std::string& path, LUTImage& image) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    CacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (std::memcmp(header.magic, kCacheMagic, 4) != 0 || header.version != kCacheVersion ||
+        header.width == 0 || header.height == 0 || header.width > 16384 || header.height > 16384) {
+        return false;
+    }
+
+    image.width = static_cast<int>(header.width);
+    image.height = static_cast<int>(header.height);
+    image.pixels.resize(static_cast<size_t>(header.width) * header.height * 4);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(image.pixels.data()),
+                                       static_cast<std::streamsize>(image.pixels.size())));
+}
+
+bool writeCache(const std::string& path, const LUTImage& image) {
+    std::error_code ec;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+
+    // 先写临时文件再改名，避免中断时留下半个缓存
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        CacheHeader header;
+        std::memcpy(header.magic, kCacheMagic, 4);
+        header.version = kCacheVersion;
+        header.width = static_cast<uint32_t>(image.width);
+        header.height = static_cast<uint32_t>(image.height);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(image.pixels.data()),
+                   static_cast<std::streamsize>(image.pixels.size()));
+        if (!file) {
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, target, ec);
+    return !ec;
+}
+
+LUTImage loadImage(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open image file: " + path);
+    }
+
+    // 读取头部的下一个字段，跳过 # 注释
+    auto nextToken = [&]() {
+        std::string token;
+        char c;
+        while (file.get(c)) {
+            if (c == '#') {
+                std::string comment;
+                std::getline(file, comment);
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                if (!token.empty()) break;
+            } else {
+                token += c;
+            }
+        }
+        return token;
+    };
+
+    std::string magic = nextToken();
+    if (magic != "P6" && magic != "P5") {
+        throw std::runtime_error("Unsupported image format (binary PPM/PGM only): " + path);
+    }
+    int width = std::stoi(nextToken());
+    int height = std::stoi(nextToken());
+    int maxValue = std::stoi(nextToken());
+    if (width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 255) {
+        throw std::runtime_error("Unsupported image header: " + path);
+    }
+
+    int components = (magic == "P6") ? 3 : 1;
+    std::vector<uint8_t> raw(static_cast<size_t>(width) * height * components);
+    if (!file.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(raw.size()))) {
+        throw std::runtime_error("Image file is truncated: " + path);
+    }
+
+    // 文件从上到下存行，纹理从下到上
+    LUTImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* src = raw.data() + static_cast<size_t>(height - 1 - y) * width * components;
+        uint8_t* dst = image.pixels.data() + static_cast<size_t>(y) * width * 4;
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                int value = src[x * components + (components == 3 ? c : 0)];
+                dst[x * 4 + c] = static_cast<uint8_t>(std::min(255, value * 255 / maxValue));
+            }
+            dst[x * 4 + 3] = 255;
+        }
+    }
+    std::cout << "Read image file: " << path << " (" << width << "x" << height << ")" << std::endl;
+    return image;
+}
+
+} // namespace NoiseLUT
@@ -1,29 +1,39 @@
 #include "Shader.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
 Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource) 
     : vao(0), vbo(0) {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
-
-    programID = glCreateProgram();
-    glAttachShader(programID, vertexShader);
-    glAttachShader(programID, fragmentShader);
-    glLinkProgram(programID);
-
-    checkLinkErrors();
+    build(vertexSource, fragmentSource);
+}
 
-    // 删除着色器，它们已经链接到程序中，不再需要了
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, bool /*fromFile*/) 
+    : vao(0), vbo(0) {
+    std::string vertexCode = readFile(vertexPath);
+    std::string fragmentCode = readFile(fragmentPath);
+    build(vertexCode, fragmentCode);
 }
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, bool fromFile) {
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath,
+               const std::vector<std::string>& defines, const std::string& preludePath)
+    : vao(0), vbo(0) {
     std::string vertexCode = readFile(vertexPath);
     std::string fragmentCode = readFile(fragmentPath);
-    
+
+    std::string preamble;
+    for (const auto& define : defines) {
+        preamble += "#define " + define + "\n";
+    }
+    if (!preludePath.empty()) {
+        preamble += readFile(preludePath);
+        preamble += "\n";
+    }
+    build(vertexCode, injectPreamble(fragmentCode, preamble));
+}
+
+void Shader::build(const std::string& vertexCode, const std::string& fragmentCode) {
     GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexCode);
     GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentCode);
 
@@ -34,10 +44,30 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, b
 
     checkLinkErrors();
 
+    // 删除着色器，它们已经链接到程序中，不再需要了
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 }
 
+std::string Shader::injectPreamble(const std::string& source, const std::string& preamble) {
+    if (preamble.empty()) {
+        return source;
+    }
+    // GLSL 要求 #version 位于最前，注入内容放在其后一行
+    size_t versionPos = source.find("#version");
+    if (versionPos == std::string::npos) {
+        return preamble + source;
+    }
+    size_t lineEnd = source.find('\n', versionPos);
+    if (lineEnd == std::string::npos) {
+        return source + "\n" + preamble;
+    }
+    // #line 让编译错误中的行号仍对应原文件
+    int nextLine = static_cast<int>(std::count(source.begin(), source.begin() + lineEnd, '\n')) + 2;
+    return source.substr(0, lineEnd + 1) + preamble + "#line " + std::to_string(nextLine) + "\n"
+           + source.substr(lineEnd + 1);
+}
+
 Shader::~Shader() {
     if (vao != 0) {
         glDeleteVertexArrays(1, &vao);
@@ -6,12 +6,12 @@
 GPUConfig Window::gpuConfig = GPUConfig();
 
 Window::Window(int width, int height, const std::string& title) 
-    : window(nullptr), initialized(false) {
+    : window(nullptr), initialized(false), inputMailbox(nullptr) {
     setupWindow(width, height, title);
 }
 
 Window::Window(const WindowConfig& config)
-    : window(nullptr), initialized(false) {
+    : window(nullptr), initialized(false), inputMailbox(nullptr) {
     setupWindow(config.width, config.height, config.title);
     
     // 设置 VSync
@@ -97,6 +97,10 @@ bool Window::shouldClose() const {
     return glfwWindowShouldClose(window);
 }
 
+void Window::requestClose() {
+    glfwSetWindowShouldClose(window, 1);
+}
+
 void Window::makeContextCurrent() {
     glfwMakeContextCurrent(window);
 }
@@ -109,6 +113,48 @@ void Window::pollEvents() {
     glfwPollEvents();
 }
 
+void Window::waitEvents() {
+    glfwWaitEvents();
+}
+
+void Window::attachInput(Mailbox<InputState>& mailbox) {
+    inputMailbox = &mailbox;
+    glfwSetWindowUserPointer(window, this);
+
+    // 发布初始状态，渲染线程第一帧即可拿到有效尺寸
+    glfwGetCursorPos(window, &inputState.cursorX, &inputState.cursorY);
+    glfwGetFramebufferSize(window, &inputState.framebufferWidth, &inputState.framebufferHeight);
+    glfwGetWindowSize(window, &inputState.windowWidth, &inputState.windowHeight);
+    inputState.cursorTimestamp = glfwGetTime();
+    mailbox.publish(inputState);
+
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetWindowSizeCallback(window, windowSizeCallback);
+}
+
+void Window::cursorPosCallback(GLFWwindow* glfwWindow, double xpos, double ypos) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+    self->inputState.cursorX = xpos;
+    self->inputState.cursorY = ypos;
+    self->inputState.cursorTimestamp = glfwGetTime();
+    self->inputMailbox->publish(self->inputState);
+}
+
+void Window::framebufferSizeCallback(GLFWwindow* glfwWindow, int width, int height) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+    self->inputState.framebufferWidth = width;
+    self->inputState.framebufferHeight = height;
+    self->inputMailbox->publish(self->inputState);
+}
+
+void Window::windowSizeCallback(GLFWwindow* glfwWindow, int width, int height) {
+    Window* self = static_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+    self->inputState.windowWidth = width;
+    self->inputState.windowHeight = height;
+    self->inputMailbox->publish(self->inputState);
+}
+
 void Window::getFramebufferSize(int& width, int& height) const {
     glfwGetFramebufferSize(window, &width, &height);
 }
@@ -123,4 +169,12 @@ void Window::setTitle(const std::string& title) {
 
 void Window::setGPUConfig(const GPUConfig& config) {
     gpuConfig = config;
+}
+
+void Window::detachCurrentContext() {
+    glfwMakeContextCurrent(nullptr);
+}
+
+void Window::wakeEventLoop() {
+    glfwPostEmptyEvent();
 }
\ No newline at end of file
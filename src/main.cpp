@@ -3,23 +3,234 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include <vector>
 #include "Shader.h"
 #include "Window.h"
 #include "Config.h"
+#include "FoveatedRenderer.h"
+#include "DistancePrepass.h"
+#include "ChannelTextures.h"
+#include "Mesh.h"
+#include "Mailbox.h"
 
-int main() 
+// 渲染线程：持有 OpenGL 上下文，输入只通过信箱获取
+static void renderLoop(Window& window, const Config& config,
+                       Mailbox<InputState>& inputMailbox, Mailbox<std::string>& titleMailbox,
+                       const std::atomic<bool>& running)
+{
+    const auto& windowConfig = config.getWindowConfig();
+    const auto& perfConfig = config.getPerformanceConfig();
+    ShaderScene activeScene = config.getActiveScene();
+
+    // 创建着色器程序（使用配置的shader路径）
+    // 启用距离预通道时，全分辨率着色器以 READ 分支编译
+    std::cout << "Loading shaders..." << std::endl;
+    std::vector<std::string> shaderDefines = activeScene.defines;
+    std::string preludePath;
+    if (activeScene.prepass.enabled) {
+        shaderDefines.push_back(DistancePrepass::kReadDefine);
+        preludePath = DistancePrepass::kPreludePath;
+    }
+    Shader shader(activeScene.vertexShader, activeScene.fragmentShader, shaderDefines, preludePath);
+    std::cout << "Shaders loaded successfully." << std::endl;
+    shader.setupQuad();
+
+    // 距离预通道（按场景配置启用）
+    std::unique_ptr<DistancePrepass> distancePrepass;
+    if (activeScene.prepass.enabled) {
+        distancePrepass = std::make_unique<DistancePrepass>(activeScene);
+    }
+
+    // 纹理输入 iChannel0..3（按场景配置）
+    std::unique_ptr<ChannelTextures> channelTextures;
+    if (!activeScene.channels.empty()) {
+        channelTextures = std::make_unique<ChannelTextures>(activeScene.channels);
+    }
+
+    // 网格场景：索引+实例化绘制，需要深度测试
+    std::unique_ptr<Mesh> mesh;
+    GLbitfield clearMask = GL_COLOR_BUFFER_BIT;
+    if (!activeScene.mesh.path.empty()) {
+        mesh = std::make_unique<Mesh>(activeScene.mesh);
+        glEnable(GL_DEPTH_TEST);
+        clearMask |= GL_DEPTH_BUFFER_BIT;
+    }
+
+    // 注视点渲染（按场景配置启用）
+    std::unique_ptr<FoveatedRenderer> foveatedRenderer;
+    if (activeScene.foveation.enabled) {
+        foveatedRenderer = std::make_unique<FoveatedRenderer>(activeScene.foveation);
+    }
+
+    std::cout << "GPU acceleration enabled. Starting render loop...\n" << std::endl;
+
+    // FPS 计数器变量（使用配置的更新间隔）
+    double lastTime = glfwGetTime();
+    double lastFrameTime = lastTime;
+    int frameCount = 0;
+    double fpsUpdateInterval = perfConfig.fpsUpdateInterval;
+
+    // 性能统计
+    double minFrameTime = 999999.0;
+    double maxFrameTime = 0.0;
+
+    // 输入到画面延迟统计（鼠标事件时间 -> 该帧 swap 返回）
+    InputState input;
+    double lastCursorTimestamp = 0.0;
+    double latencySum = 0.0;
+    double latencyMax = 0.0;
+    int latencySamples = 0;
+
+    // 主循环
+    while (running.load(std::memory_order_relaxed)) {
+        // 清除颜色（网格场景还有深度）缓冲
+        glClear(clearMask);
+
+        // 更新uniform变量
+        float currentTime = glfwGetTime();
+
+        // 延迟锁存：在提交绘制前的最后时刻读取最新输入
+        inputMailbox.read(input);
+        int width = input.framebufferWidth;
+        int height = input.framebufferHeight;
+        double xpos = input.cursorX;
+        double ypos = input.cursorY;
+
+        // 场景 uniform，全分辨率通道与预通道共用
+        auto setSceneUniforms = [&](Shader& target, int targetWidth, int targetHeight) {
+            target.setFloat("iTime", currentTime);
+            target.setVec2("iResolution", static_cast<float>(targetWidth), static_cast<float>(targetHeight));
+            target.setVec2("iMouse", static_cast<float>(xpos), static_cast<float>(ypos));
+            if (channelTextures) {
+                channelTextures->bind(target);
+            }
+        };
+
+        // 以给定分辨率绘制场景（注视点渲染会以不同分辨率调用多次）
+        auto drawScene = [&](int targetWidth, int targetHeight) {
+            if (distancePrepass) {
+                distancePrepass->run(targetWidth, targetHeight, setSceneUniforms);
+            }
+
+            shader.use();
+            glBindVertexArray(shader.getVAO());
+            setSceneUniforms(shader, targetWidth, targetHeight);
+            if (distancePrepass) {
+                distancePrepass->bind(shader);
+            }
+
+            if (mesh) {
+                mesh->draw(shader);
+            } else {
+                // 绘制四边形
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            }
+        };
+
+        if (foveatedRenderer) {
+            // 鼠标坐标为窗口坐标（左上角原点），换算到帧缓冲像素（左下角原点）
+            float scaleX = input.windowWidth > 0 ? static_cast<float>(width) / input.windowWidth : 1.0f;
+            float scaleY = input.windowHeight > 0 ? static_cast<float>(height) / input.windowHeight : 1.0f;
+            float cursorX = static_cast<float>(xpos) * scaleX;
+            float cursorY = height - static_cast<float>(ypos) * scaleY;
+            foveatedRenderer->render(width, height, cursorX, cursorY, drawScene);
+        } else {
+            glViewport(0, 0, width, height);
+            drawScene(width, height);
+        }
+
+        // 交换缓冲（事件由主线程处理）
+        window.swapBuffers();
+
+        // 计算并更新FPS
+        frameCount++;
+        double currentFrameTime = glfwGetTime();
+        double totalDeltaTime = currentFrameTime - lastTime;
+        double frameDeltaTime = currentFrameTime - lastFrameTime;
+
+        // 只统计本帧新到达的鼠标事件
+        if (input.cursorTimestamp != lastCursorTimestamp) {
+            double latencyMs = (currentFrameTime - input.cursorTimestamp) * 1000.0;
+            latencySum += latencyMs;
+            if (latencyMs > latencyMax) latencyMax = latencyMs;
+            latencySamples++;
+            lastCursorTimestamp = input.cursorTimestamp;
+        }
+
+        // 每帧计算帧时间用于统计（毫秒）
+        if (frameCount > 1) {  // 跳过第一帧
+            double singleFrameMs = frameDeltaTime * 1000.0;
+            if (singleFrameMs < minFrameTime) minFrameTime = singleFrameMs;
+            if (singleFrameMs > maxFrameTime) maxFrameTime = singleFrameMs;
+        }
+
+        lastFrameTime = currentFrameTime;
+
+        // 定期更新FPS显示
+        if (totalDeltaTime >= fpsUpdateInterval) {
+            double fps = frameCount / totalDeltaTime;
+            double avgMs = (totalDeltaTime * 1000.0) / frameCount;
+
+            // 根据配置决定是否更新窗口标题（标题只能在主线程设置）
+            if (perfConfig.showTitleFps) {
+                std::ostringstream title;
+                title << windowConfig.title << " [GPU] | FPS: " << std::fixed << std::setprecision(1)
+                      << fps << " | Avg: " << std::setprecision(2) << avgMs << "ms";
+
+                // 只有当有有效数据时才显示最小/最大值
+                if (minFrameTime < 999999.0 && maxFrameTime > 0.0) {
+                    title << " | Min: " << std::setprecision(0) << (1000.0 / maxFrameTime) << "fps"
+                          << " | Max: " << std::setprecision(0) << (1000.0 / minFrameTime) << "fps";
+                }
+                if (latencySamples > 0) {
+                    title << " | Latency: " << std::setprecision(1) << (latencySum / latencySamples) << "ms";
+                }
+
+                titleMailbox.publish(title.str());
+                Window::wakeEventLoop();
+            }
+
+            // 根据配置决定是否输出到终端
+            if (perfConfig.showConsoleFps) {
+                std::cout << "FPS: " << std::fixed << std::setprecision(1) << fps
+                          << " | Avg: " << std::setprecision(2) << avgMs << "ms";
+                if (latencySamples > 0) {
+                    std::cout << " | Motion-to-photon: avg " << std::setprecision(2) << (latencySum / latencySamples)
+                              << "ms, max " << latencyMax << "ms";
+                }
+                std::cout << std::endl;
+            }
+
+            // 重置计数器
+            frameCount = 0;
+            lastTime = currentFrameTime;
+            minFrameTime = 999999.0;
+            maxFrameTime = 0.0;
+            latencySum = 0.0;
+            latencyMax = 0.0;
+            latencySamples = 0;
+        }
+    }
+
+    // Shader、Mesh 以及各渲染通道在此析构，此时上下文仍在本线程
+}
+
+int main()
 {
     try {
         // 加载配置文件
         std::cout << "Loading configuration..." << std::endl;
         Config config("config/shader_config.yaml");
-        
+
         // 获取配置
         const auto& windowConfig = config.getWindowConfig();
-        const auto& perfConfig = config.getPerformanceConfig();
         const auto& gpuConfig = config.getGPUConfig();
         ShaderScene activeScene = config.getActiveScene();
-        
+
         std::cout << "\n=== 配置信息 ===" << std::endl;
         std::cout << "场景: " << activeScene.name << std::endl;
         std::cout << "描述: " << activeScene.description << std::endl;
@@ -27,115 +238,63 @@ int main()
         std::cout << "片段着色器: " << activeScene.fragmentShader << std::endl;
         std::cout << "窗口大小: " << windowConfig.width << "x" << windowConfig.height << std::endl;
         std::cout << "VSync: " << (windowConfig.vsync ? "开启" : "关闭") << std::endl;
+        std::cout << "注视点渲染: " << (activeScene.foveation.enabled ? "开启" : "关闭") << std::endl;
+        std::cout << "距离预通道: ";
+        if (activeScene.prepass.enabled) {
+            std::cout << "开启 (1/" << activeScene.prepass.scale << ")" << std::endl;
+        } else {
+            std::cout << "关闭" << std::endl;
+        }
         std::cout << "OpenGL: " << gpuConfig.openglMajor << "." << gpuConfig.openglMinor << std::endl;
         std::cout << "=================\n" << std::endl;
-        
+
         // 初始化GLFW
         Window::initGLFW();
-        
+
         // 设置GPU配置
         Window::setGPUConfig(gpuConfig);
 
         // 创建窗口（使用配置）
         Window window(windowConfig);
 
-        // 创建着色器程序（使用配置的shader路径）
-        std::cout << "Loading shaders..." << std::endl;
-        Shader shader(activeScene.vertexShader, activeScene.fragmentShader, true);
-        std::cout << "Shaders loaded successfully." << std::endl;
-        shader.setupQuad();
-        
-        std::cout << "GPU acceleration enabled. Starting render loop...\n" << std::endl;
-
-        // FPS 计数器变量（使用配置的更新间隔）
-        double lastTime = glfwGetTime();
-        double lastFrameTime = lastTime;
-        int frameCount = 0;
-        double fpsUpdateInterval = perfConfig.fpsUpdateInterval;
-        
-        // 性能统计
-        double minFrameTime = 999999.0;
-        double maxFrameTime = 0.0;
-
-        // 主循环
-        while (!window.shouldClose()) {
-            // 清除颜色缓冲
-            glClear(GL_COLOR_BUFFER_BIT);
-
-            // 使用着色器程序
-            shader.use();
+        // 主线程负责事件，渲染交给独立线程；两者之间只通过无锁信箱通信
+        Mailbox<InputState> inputMailbox;
+        Mailbox<std::string> titleMailbox;
+        window.attachInput(inputMailbox);
+        Window::detachCurrentContext();
 
-            // 更新uniform变量
-            float currentTime = glfwGetTime();
-            int width, height;
-            window.getFramebufferSize(width, height);
-            
-            shader.setFloat("iTime", currentTime);
-            shader.setVec2("iResolution", static_cast<float>(width), static_cast<float>(height));
-
-            // 获取鼠标位置
-            double xpos, ypos;
-            window.getCursorPos(xpos, ypos);
-            shader.setVec2("iMouse", static_cast<float>(xpos), static_cast<float>(ypos));
-
-            // 绘制四边形
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-            // 交换缓冲并处理事件
-            window.swapBuffers();
-            window.pollEvents();
-
-            // 计算并更新FPS
-            frameCount++;
-            double currentFrameTime = glfwGetTime();
-            double totalDeltaTime = currentFrameTime - lastTime;
-            double frameDeltaTime = currentFrameTime - lastFrameTime;
-            
-            // 每帧计算帧时间用于统计（毫秒）
-            if (frameCount > 1) {  // 跳过第一帧
-                double singleFrameMs = frameDeltaTime * 1000.0;
-                if (singleFrameMs < minFrameTime) minFrameTime = singleFrameMs;
-                if (singleFrameMs > maxFrameTime) maxFrameTime = singleFrameMs;
+        std::atomic<bool> running(true);
+        std::exception_ptr renderError;
+        std::thread renderThread([&]() {
+            try {
+                window.makeContextCurrent();
+                renderLoop(window, config, inputMailbox, titleMailbox, running);
             }
-            
-            lastFrameTime = currentFrameTime;
-            
-            // 定期更新FPS显示
-            if (totalDeltaTime >= fpsUpdateInterval) {
-                double fps = frameCount / totalDeltaTime;
-                double avgMs = (totalDeltaTime * 1000.0) / frameCount;
-                
-                // 根据配置决定是否更新窗口标题
-                if (perfConfig.showTitleFps) {
-                    std::ostringstream title;
-                    title << windowConfig.title << " [GPU] | FPS: " << std::fixed << std::setprecision(1) 
-                          << fps << " | Avg: " << std::setprecision(2) << avgMs << "ms";
-                    
-                    // 只有当有有效数据时才显示最小/最大值
-                    if (minFrameTime < 999999.0 && maxFrameTime > 0.0) {
-                        title << " | Min: " << std::setprecision(0) << (1000.0 / maxFrameTime) << "fps"
-                              << " | Max: " << std::setprecision(0) << (1000.0 / minFrameTime) << "fps";
-                    }
-                    
-                    window.setTitle(title.str());
-                }
-                
-                // 根据配置决定是否输出到终端
-                if (perfConfig.showConsoleFps) {
-                    std::cout << "FPS: " << std::fixed << std::setprecision(1) << fps 
-                              << " | Avg: " << std::setprecision(2) << avgMs << "ms" << std::endl;
-                }
-                
-                // 重置计数器
-                frameCount = 0;
-                lastTime = currentFrameTime;
-                minFrameTime = 999999.0;
-                maxFrameTime = 0.0;
+            catch (...) {
+                renderError = std::current_exception();
+            }
+            // 窗口销毁前上下文不能留在其他线程
+            Window::detachCurrentContext();
+            window.requestClose();
+            Window::wakeEventLoop();
+        });
+
+        // 事件循环：拖动/缩放窗口时只阻塞这里，不阻塞渲染
+        std::string title;
+        while (!window.shouldClose()) {
+            window.waitEvents();
+            if (titleMailbox.read(title)) {
+                window.setTitle(title);
             }
         }
 
+        running.store(false, std::memory_order_relaxed);
+        renderThread.join();
+        if (renderError) {
+            std::rethrow_exception(renderError);
+        }
+
         // Window的析构函数会自动清理窗口资源
-        // Shader的析构函数会自动清理VAO和VBO
         Window::terminateGLFW();
         return 0;
     }
@@ -145,4 +304,3 @@ int main()
         return -1;
     }
 }
-